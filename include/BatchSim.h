@@ -0,0 +1,69 @@
+#ifndef SNAKE_TERRA_BATCHSIM_H
+#define SNAKE_TERRA_BATCHSIM_H
+
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+namespace snaketerra {
+
+// Runs LANES independent headless games in lockstep on one board size.
+// Per-lane state is kept as struct-of-arrays so the per-tick work (autopilot
+// choice, head advance, bounds, occupancy, food hit) is done for all lanes
+// at once with AVX2 when the CPU has it. Rules and autopilot match
+// GameBoard::simulate with the same seed, game for game.
+class BatchSim {
+public:
+    static const int LANES = 8;
+
+    BatchSim(int rows, int cols);
+
+    // Start one game per lane; seeds[i] != 0 feeds Food::next_pick for lane i.
+    void reset(const unsigned* seeds);
+    // Advance every live lane by one tick. Returns the number of live lanes.
+    int step();
+    // reset() then step() until all lanes finish or max_ticks elapse.
+    void run(const unsigned* seeds, int max_ticks);
+
+    int score(int lane) const;
+    bool alive(int lane) const;
+
+    // True when step() runs the AVX2 kernel: the CPU has it and the
+    // generic kernel is not forced.
+    static bool uses_avx2();
+    // Run the lane-loop kernel even on AVX2 CPUs (to measure the SIMD gain).
+    static void force_generic(bool on);
+
+private:
+    struct Tick; // per-tick kernel output
+    void commit(const Tick& t);
+    void spawn_food(int lane);
+
+    int rows_;
+    int cols_;
+    int cells_;
+    int cap_; // ring capacity per lane
+
+    alignas(32) int32_t head_r_[LANES];
+    alignas(32) int32_t head_c_[LANES];
+    alignas(32) int32_t dir_[LANES];
+    alignas(32) int32_t food_r_[LANES];
+    alignas(32) int32_t food_c_[LANES];
+    alignas(32) int32_t tail_r_[LANES];
+    alignas(32) int32_t tail_c_[LANES];
+    alignas(32) int32_t grow_[LANES];  // -1 when the next move keeps the tail
+    alignas(32) int32_t alive_[LANES]; // -1 live, 0 finished (masked)
+    int32_t score_[LANES];
+    int32_t ring_head_[LANES];
+    int32_t ring_tail_[LANES];
+    unsigned rng_[LANES];
+
+    vector<Point> ring_;   // LANES * cap_ body segments, tail..head per lane
+    vector<uint8_t> occ_;  // LANES * cells_ occupancy (+3 bytes gather padding)
+};
+
+} // namespace snaketerra
+
+#endif // SNAKE_TERRA_BATCHSIM_H
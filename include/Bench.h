@@ -0,0 +1,16 @@
+#ifndef SNAKE_TERRA_BENCH_H
+#define SNAKE_TERRA_BENCH_H
+
+using namespace std;
+
+namespace snaketerra {
+
+// Scripted headless workload: autopilot games on several board sizes plus
+// leaderboard add/load/save. Used as the PGO training run and as the
+// benchmark that `make release-pgo` compares builds with.
+// Prints per-workload timings and returns a process exit code.
+int run_bench(int rounds);
+
+} // namespace snaketerra
+
+#endif // SNAKE_TERRA_BENCH_H
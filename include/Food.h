@@ -14,6 +14,12 @@ public:
     Food();
     Point pos() const;
     void spawn(int rows, int cols, const Snake& snake);
+    // Place food at empty cell number (pick % empty_count) in row-major order.
+    void spawn(int rows, int cols, const Snake& snake, unsigned pick);
+
+    // Deterministic pick stream (xorshift32) for seeded headless games.
+    // state must be non-zero and stays non-zero.
+    static unsigned next_pick(unsigned& state);
 
 private:
     Point pos_;
@@ -6,6 +6,7 @@
 #include "Food.h"
 #include "Leaderboard.h"
 #include <string>
+#include <vector>
 
 // forward-declare ncurses internal window struct type
 struct _win_st;
@@ -16,37 +17,59 @@ namespace snaketerra {
 
 enum class Difficulty { EASY = 220, NORMAL = 140, HARD = 80 };
 
+// Screens driven by GameBoard::run(); each returns the one to show next.
+enum class Scene { MENU, PLAY, GAME_OVER, LEADERBOARD, DIFFICULTY, QUIT };
+
 class GameBoard {
 public:
-    GameBoard(int rows = 20, int cols = 30);
+    GameBoard(int rows = 20, int cols = 30, const string& leaderboard_path = "leaderboard.txt");
     ~GameBoard();
 
+    // Pack two board rows into one terminal row with Unicode half blocks.
+    // Must be set before init_ncurses(); ignored when the locale is not UTF-8.
+    void set_half_block(bool on);
+
     void init_ncurses();
     void shutdown_ncurses();
 
     // Entry point
     void run();
 
+    // Headless play (no ncurses): an autopilot drives one game on a
+    // rows x cols board until it dies or max_ticks elapse. Returns the score.
+    // A non-zero seed places food from Food::next_pick instead of rand().
+    int simulate(int rows, int cols, int max_ticks, unsigned seed = 0);
+
 private:
     // UI helpers
-    int show_main_menu();
+    Scene show_main_menu();
     void draw_banner_to_win(void* win_ptr, int start_y, int max_w);
     void draw_hash_banner_to_win(struct _win_st* win, int start_y, int max_w);
 
-    void show_leaderboard_screen();
-    void change_difficulty_screen();
+    Scene show_leaderboard_screen();
+    Scene change_difficulty_screen();
+
+    // Windows are created on first use and moved/resized afterwards, so
+    // scenes and restarts reuse the same ncurses allocations.
+    struct _win_st* place_win(struct _win_st*& slot, int h, int w, int y, int x);
+    struct _win_st* place_subwin(struct _win_st*& slot, struct _win_st* parent, int h, int w, int y, int x);
+    void destroy_windows();
 
     // game
-    void play_game();
+    Scene play_game();
     void step();
+    void spawn_food();
     void handle_input(int ch);
+    void draw_board_half_block(struct _win_st* win);
+    Dir autopilot_dir() const;
 
     // game-over & prompts
     string prompt_name_and_save();
-    void show_game_over_screen(const string& name);
+    Scene show_game_over_screen();
 
     // utilities
     static string difficulty_to_string(Difficulty d);
+    static bool terminal_supports_utf8();
     string difficulty_str() const;
 
 private:
@@ -57,8 +80,21 @@ private:
     int score_;
     bool running_;
     int cell_w_;
+    bool half_block_;
+    vector<unsigned char> cells_; // per-frame cell kinds for half-block drawing
     Leaderboard leaderboard_;
     Difficulty difficulty_;
+    unsigned food_seed_; // 0: food placed with rand()
+    string last_name_;   // player of the game shown on the game-over screen
+
+    struct _win_st* menu_win_;
+    struct _win_st* popup_win_;   // leaderboard, difficulty, notices
+    struct _win_st* prompt_win_;
+    struct _win_st* game_over_win_;
+    struct _win_st* board_win_;
+    struct _win_st* info_win_;
+    struct _win_st* info_score_win_;
+    struct _win_st* info_top3_win_;
 
     int play_rows_;
     int play_cols_;
@@ -1,6 +1,9 @@
 #ifndef SNAKE_TERRA_LEADERBOARD_H
 #define SNAKE_TERRA_LEADERBOARD_H
 
+#include "ScoreTable.h"
+#include "SharedScores.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -8,30 +11,43 @@ using namespace std;
 
 namespace snaketerra {
 
-struct ScoreEntry {
-    string name;
-    int score;
-};
-
+// Scores live in a shared-memory table common to every session using the
+// same file (see SharedScores); the file is the durable copy and is only
+// parsed by the session that creates the table. Without shared memory the
+// leaderboard works from the file alone.
 class Leaderboard {
 public:
     explicit Leaderboard(const string& path = "leaderboard.txt");
 
     void load();
     void save();
-    void add(const string& name, int score);
+    // difficulty is the Difficulty tick in ms, 0 if unknown
+    void add(const string& name, int score, int difficulty = 0);
+
+    vector<ScoreRecord> top(int n = 3) const;
+    // Ranked records; valid until the next call on this leaderboard.
+    const vector<ScoreRecord>& all() const;
+    const char* name(const ScoreRecord& r) const;
+
+    // Per-player queries; names are matched after sanitising.
+    int best(const string& name) const; // -1 if the player has no scores
+    vector<ScoreRecord> history(const string& name) const;
 
-    vector<ScoreEntry> top(int n = 3) const;
-    vector<ScoreEntry> all() const;
+    // Forget the shared table for `path`; the next session reloads the file.
+    static void drop_shared(const string& path);
 
 private:
-    void sort_and_trim();
+    void refresh() const;
+    void read_file(ScoreTable& out) const;
+    void write_file(const ScoreTable& table) const;
     static string sanitize_name(const string& s);
 
     string path_;
-    vector<ScoreEntry> entries_;
+    SharedScores shared_;
+    mutable ScoreTable table_;
+    mutable uint32_t seen_version_;
 };
 
 } // namespace snaketerra
 
-#endif // SNAKE_TERRA_LEADERBOARD_H
\ No newline at end of file
+#endif // SNAKE_TERRA_LEADERBOARD_H
@@ -0,0 +1,74 @@
+#ifndef SNAKE_TERRA_SCORETABLE_H
+#define SNAKE_TERRA_SCORETABLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace snaketerra {
+
+// One leaderboard entry. The name lives once in the table's name pool.
+struct ScoreRecord {
+    uint16_t player;     // index into the name pool
+    uint8_t difficulty;  // Difficulty tick in ms (220/140/80), 0 if unknown
+    uint8_t reserved;
+    int32_t score;
+    uint32_t time;       // unix seconds, 0 if unknown
+};
+
+// Interned player names plus packed score records in contiguous arrays.
+class ScoreTable {
+public:
+    static constexpr int NAME_LEN = 16;
+    static constexpr int MAX_RECORDS = 200;
+    static constexpr int MAX_PLAYERS = MAX_RECORDS; // enough after compact()
+    static constexpr uint16_t NO_PLAYER = 0xFFFF;
+
+    ScoreTable();
+
+    void clear();
+
+    // Id for `name` (truncated to NAME_LEN), added if new; NO_PLAYER when full.
+    uint16_t intern(const string& name);
+    // Id for `name` without adding it; NO_PLAYER if unknown.
+    uint16_t find(const string& name) const;
+    const char* name(uint16_t id) const;
+    int player_count() const;
+    // Append a name slot as-is (used when mirroring another table's pool).
+    void append_name(const char* s);
+
+    // Insert a record, keeping at most MAX_RECORDS. Returns false when the
+    // table is full and the score would not make the cut.
+    bool add(const string& name, int score, int difficulty, uint32_t time);
+    // Score descending, then name ascending; drops records past MAX_RECORDS.
+    void sort_and_trim();
+    // Remove names no record refers to and renumber the records.
+    void compact();
+
+    const vector<ScoreRecord>& records() const;
+    vector<ScoreRecord>& records();
+
+    // Highest score for `player`, or -1 if it has none.
+    int best(uint16_t player) const;
+    // Every record for `player`, oldest first.
+    vector<ScoreRecord> history(uint16_t player) const;
+
+private:
+    struct Name { char s[NAME_LEN + 1]; };
+
+    bool before(int score_a, const char* name_a, int score_b, const char* name_b) const;
+    static uint32_t hash(const char* s, size_t n);
+    size_t slot_for(const char* s, size_t n) const;
+    void grow_index();
+    void rebuild_index();
+
+    vector<Name> names_;
+    vector<uint16_t> index_; // open addressing over names_, NO_PLAYER = empty; grown on demand
+    vector<ScoreRecord> records_;
+};
+
+} // namespace snaketerra
+
+#endif // SNAKE_TERRA_SCORETABLE_H
@@ -0,0 +1,63 @@
+#ifndef SNAKE_TERRA_SHAREDSCORES_H
+#define SNAKE_TERRA_SHAREDSCORES_H
+
+#include "ScoreTable.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <sys/types.h>
+
+using namespace std;
+
+namespace snaketerra {
+
+struct SharedSegment;
+
+// Score table in a POSIX shared-memory segment, shared by every process that
+// opens the same leaderboard file. Readers copy it under a seqlock and never
+// block; writers serialise on a robust process-shared mutex.
+class SharedScores {
+public:
+    SharedScores() = default;
+    ~SharedScores();
+    SharedScores(const SharedScores&) = delete;
+    SharedScores& operator=(const SharedScores&) = delete;
+
+    // Map the segment for `path`. The process that creates it fills it with
+    // `init` (normally a file parse) and gives it the file's permissions.
+    // Returns false (with a note on stderr) if the segment cannot be used;
+    // the caller should then fall back to the file.
+    bool attach(const string& path, const function<void(ScoreTable&)>& init);
+    bool attached() const { return seg_ != nullptr; }
+
+    // Bumped by every completed write; cheap to poll for changes.
+    uint32_t version() const;
+    // Bring `out` up to date with the shared table. Only names added since
+    // the last read are copied, unless the shared pool was compacted.
+    void read(ScoreTable& out) const;
+    // Read-modify-write under the writer lock. `fn` may also persist the
+    // result; it runs before other writers can see or change the table.
+    void update(const function<void(ScoreTable&)>& fn);
+
+    // Remove the segment for `path` (processes already attached keep theirs).
+    static void remove(const string& path);
+
+    // Permission bits of the file at `path`, or what a newly created file
+    // would get under the current umask.
+    static mode_t file_mode(const string& path);
+
+private:
+    static string segment_name(const string& path);
+    // The mutex lives in the segment, so locking leaves this object unchanged.
+    void lock() const;
+    void unlock() const;
+    bool try_copy_out(ScoreTable& out, uint32_t& epoch, bool locked) const;
+    void copy_in(const ScoreTable& in);
+
+    SharedSegment* seg_ = nullptr;
+    mutable uint32_t seen_epoch_ = 0; // names_epoch of the last read
+};
+
+} // namespace snaketerra
+
+#endif // SNAKE_TERRA_SHAREDSCORES_H
@@ -0,0 +1,49 @@
+#ifndef SNAKE_TERRA_TRACE_H
+#define SNAKE_TERRA_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace snaketerra {
+namespace trace {
+
+// Set once by start(); scopes test it before doing anything else.
+extern bool g_enabled;
+
+// Enable tracing and write Chrome trace-event JSON to `path` at exit
+// (open it in Perfetto or chrome://tracing).
+void start(const string& path);
+// Write the file now and stop recording. Also run automatically at exit.
+void flush();
+
+uint64_t now_ns();
+void record(const char* name, uint64_t begin_ns, uint64_t end_ns);
+
+// Records one complete ("X") event covering its lifetime.
+class Scope {
+public:
+    explicit Scope(const char* name) : name_(nullptr), begin_(0) {
+        if (__builtin_expect(g_enabled, 0)) { name_ = name; begin_ = now_ns(); }
+    }
+    ~Scope() {
+        if (__builtin_expect(name_ != nullptr, 0)) record(name_, begin_, now_ns());
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t begin_;
+};
+
+} // namespace trace
+} // namespace snaketerra
+
+#define SNAKE_TERRA_TRACE_CAT2(a, b) a##b
+#define SNAKE_TERRA_TRACE_CAT(a, b) SNAKE_TERRA_TRACE_CAT2(a, b)
+#define TRACE_SCOPE(name) \
+    ::snaketerra::trace::Scope SNAKE_TERRA_TRACE_CAT(trace_scope_, __LINE__)(name)
+
+#endif // SNAKE_TERRA_TRACE_H
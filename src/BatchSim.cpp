@@ -0,0 +1,302 @@
+#include "BatchSim.h"
+#include "Food.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SNAKE_TERRA_HAVE_AVX2_KERNEL 1
+#endif
+
+using namespace std;
+
+namespace snaketerra {
+
+// Lane-wise result of one tick, consumed by the scalar commit pass.
+struct BatchSim::Tick {
+    alignas(32) int32_t nr[LANES];   // new head
+    alignas(32) int32_t nc[LANES];
+    alignas(32) int32_t dead[LANES]; // -1: left the board or hit itself
+    alignas(32) int32_t ate[LANES];  // -1: new head is on the food
+};
+
+namespace {
+
+// Dir encoding is UP=0, DOWN=1, LEFT=2, RIGHT=3, so reverse(d) == d ^ 1.
+const int32_t D_UP = (int32_t)Dir::UP;
+const int32_t D_DOWN = (int32_t)Dir::DOWN;
+const int32_t D_LEFT = (int32_t)Dir::LEFT;
+const int32_t D_RIGHT = (int32_t)Dir::RIGHT;
+
+struct Lanes {
+    const int32_t* head_r;
+    const int32_t* head_c;
+    int32_t* dir;
+    const int32_t* food_r;
+    const int32_t* food_c;
+    const int32_t* tail_r;
+    const int32_t* tail_c;
+    const int32_t* grow;
+    const int32_t* alive;
+    const uint8_t* occ;
+    int rows;
+    int cols;
+    int cells;
+};
+
+// Reference kernel: same steps as the AVX2 one, one lane at a time.
+void kernel_generic(const Lanes& s, int32_t* nr, int32_t* nc, int32_t* dead, int32_t* ate) {
+    for (int i = 0; i < BatchSim::LANES; ++i) {
+        nr[i] = nc[i] = dead[i] = ate[i] = 0;
+        if (!s.alive[i]) continue;
+        const int32_t hr = s.head_r[i], hc = s.head_c[i], cur = s.dir[i];
+        const int32_t fr = s.food_r[i], fc = s.food_c[i];
+        const uint8_t* occ = s.occ + (size_t)i * s.cells;
+
+        // autopilot (GameBoard::autopilot_dir)
+        const int32_t cand[7] = {fr < hr ? D_UP : D_DOWN, fc < hc ? D_LEFT : D_RIGHT,
+                                 cur, D_UP, D_DOWN, D_LEFT, D_RIGHT};
+        const bool enabled[7] = {fr != hr, fc != hc, true, true, true, true, true};
+        int32_t d = cur;
+        for (int k = 0; k < 7; ++k) {
+            if (!enabled[k] || cand[k] == (cur ^ 1)) continue;
+            int32_t r = hr + (cand[k] == D_DOWN) - (cand[k] == D_UP);
+            int32_t c = hc + (cand[k] == D_RIGHT) - (cand[k] == D_LEFT);
+            if (r < 0 || r >= s.rows || c < 0 || c >= s.cols) continue;
+            if (occ[r * s.cols + c]) continue;
+            d = cand[k];
+            break;
+        }
+        s.dir[i] = d;
+
+        // Snake::move + GameBoard::step checks
+        int32_t r = hr + (d == D_DOWN) - (d == D_UP);
+        int32_t c = hc + (d == D_RIGHT) - (d == D_LEFT);
+        nr[i] = r;
+        nc[i] = c;
+        if (r < 0 || r >= s.rows || c < 0 || c >= s.cols) { dead[i] = -1; continue; }
+        int hits = occ[r * s.cols + c];
+        if (!s.grow[i] && r == s.tail_r[i] && c == s.tail_c[i]) hits -= 1; // tail moves away
+        if (hits > 0) { dead[i] = -1; continue; }
+        ate[i] = (r == fr && c == fc) ? -1 : 0;
+    }
+}
+
+#ifdef SNAKE_TERRA_HAVE_AVX2_KERNEL
+
+__attribute__((target("avx2")))
+inline __m256i load8(const int32_t* p) { return _mm256_load_si256((const __m256i*)p); }
+
+__attribute__((target("avx2")))
+inline __m256i in_bounds(__m256i r, __m256i c, __m256i rows, __m256i cols) {
+    const __m256i neg1 = _mm256_set1_epi32(-1);
+    __m256i ok = _mm256_and_si256(_mm256_cmpgt_epi32(r, neg1), _mm256_cmpgt_epi32(rows, r));
+    return _mm256_and_si256(ok, _mm256_and_si256(_mm256_cmpgt_epi32(c, neg1), _mm256_cmpgt_epi32(cols, c)));
+}
+
+// Occupancy byte at (r, c) for each lane whose mask is set; 0 elsewhere.
+__attribute__((target("avx2")))
+inline __m256i occupancy(const Lanes& s, __m256i r, __m256i c, __m256i lane_base, __m256i mask) {
+    __m256i idx = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(r, _mm256_set1_epi32(s.cols)), c), lane_base);
+    __m256i v = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)s.occ, idx, mask, 1);
+    return _mm256_and_si256(v, _mm256_set1_epi32(0xFF));
+}
+
+__attribute__((target("avx2")))
+void kernel_avx2(const Lanes& s, int32_t* nr_out, int32_t* nc_out, int32_t* dead_out, int32_t* ate_out) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i up = _mm256_set1_epi32(D_UP), down = _mm256_set1_epi32(D_DOWN);
+    const __m256i left = _mm256_set1_epi32(D_LEFT), right = _mm256_set1_epi32(D_RIGHT);
+    const __m256i rows = _mm256_set1_epi32(s.rows), cols = _mm256_set1_epi32(s.cols);
+    const __m256i lane_base = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                 _mm256_set1_epi32(s.cells));
+
+    const __m256i alive = load8(s.alive);
+    const __m256i hr = load8(s.head_r), hc = load8(s.head_c), cur = load8(s.dir);
+    const __m256i fr = load8(s.food_r), fc = load8(s.food_c);
+    const __m256i rev = _mm256_xor_si256(cur, one);
+
+    // autopilot: first valid candidate wins, lanes already decided are masked
+    const __m256i cand[7] = {
+        _mm256_blendv_epi8(down, up, _mm256_cmpgt_epi32(hr, fr)),
+        _mm256_blendv_epi8(right, left, _mm256_cmpgt_epi32(hc, fc)),
+        cur, up, down, left, right
+    };
+    const __m256i all = _mm256_set1_epi32(-1);
+    const __m256i enabled[2] = {
+        _mm256_xor_si256(_mm256_cmpeq_epi32(fr, hr), all),
+        _mm256_xor_si256(_mm256_cmpeq_epi32(fc, hc), all)
+    };
+    __m256i chosen = cur;
+    __m256i found = _mm256_xor_si256(alive, all); // finished lanes never search
+    for (int k = 0; k < 7; ++k) {
+        __m256i d = cand[k];
+        __m256i r = _mm256_add_epi32(hr, _mm256_sub_epi32(_mm256_cmpeq_epi32(d, up), _mm256_cmpeq_epi32(d, down)));
+        __m256i c = _mm256_add_epi32(hc, _mm256_sub_epi32(_mm256_cmpeq_epi32(d, left), _mm256_cmpeq_epi32(d, right)));
+        __m256i ok = _mm256_andnot_si256(found, in_bounds(r, c, rows, cols));
+        ok = _mm256_andnot_si256(_mm256_cmpeq_epi32(d, rev), ok);
+        if (k < 2) ok = _mm256_and_si256(ok, enabled[k]);
+        if (_mm256_testz_si256(ok, ok)) continue;
+        ok = _mm256_and_si256(ok, _mm256_cmpeq_epi32(occupancy(s, r, c, lane_base, ok), zero));
+        chosen = _mm256_blendv_epi8(chosen, d, ok);
+        found = _mm256_or_si256(found, ok);
+        if (_mm256_testc_si256(found, all)) break;
+    }
+    _mm256_store_si256((__m256i*)s.dir, _mm256_blendv_epi8(cur, chosen, alive));
+
+    // advance head, then wall / self / food checks
+    __m256i nr = _mm256_add_epi32(hr, _mm256_sub_epi32(_mm256_cmpeq_epi32(chosen, up), _mm256_cmpeq_epi32(chosen, down)));
+    __m256i nc = _mm256_add_epi32(hc, _mm256_sub_epi32(_mm256_cmpeq_epi32(chosen, left), _mm256_cmpeq_epi32(chosen, right)));
+    __m256i inb = _mm256_and_si256(alive, in_bounds(nr, nc, rows, cols));
+    __m256i hits = occupancy(s, nr, nc, lane_base, inb);
+    __m256i on_tail = _mm256_and_si256(_mm256_cmpeq_epi32(nr, load8(s.tail_r)), _mm256_cmpeq_epi32(nc, load8(s.tail_c)));
+    on_tail = _mm256_andnot_si256(load8(s.grow), on_tail);
+    hits = _mm256_add_epi32(hits, on_tail); // on_tail is -1 where the tail vacates
+    __m256i self = _mm256_cmpgt_epi32(hits, zero);
+    __m256i dead = _mm256_and_si256(alive, _mm256_or_si256(_mm256_xor_si256(inb, all), self));
+    __m256i ate = _mm256_andnot_si256(dead, _mm256_and_si256(alive,
+                      _mm256_and_si256(_mm256_cmpeq_epi32(nr, fr), _mm256_cmpeq_epi32(nc, fc))));
+
+    _mm256_store_si256((__m256i*)nr_out, _mm256_and_si256(nr, alive));
+    _mm256_store_si256((__m256i*)nc_out, _mm256_and_si256(nc, alive));
+    _mm256_store_si256((__m256i*)dead_out, dead);
+    _mm256_store_si256((__m256i*)ate_out, ate);
+}
+
+#endif // SNAKE_TERRA_HAVE_AVX2_KERNEL
+
+} // namespace
+
+BatchSim::BatchSim(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      cells_(rows * cols),
+      cap_(rows * cols + 2),
+      ring_((size_t)LANES * (rows * cols + 2)),
+      occ_((size_t)LANES * rows * cols + 3, 0)
+{
+    for (int i = 0; i < LANES; ++i) alive_[i] = 0;
+}
+
+namespace {
+bool g_force_generic = false;
+}
+
+bool BatchSim::uses_avx2() {
+#ifdef SNAKE_TERRA_HAVE_AVX2_KERNEL
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has && !g_force_generic;
+#else
+    return false;
+#endif
+}
+
+void BatchSim::force_generic(bool on) { g_force_generic = on; }
+
+void BatchSim::reset(const unsigned* seeds) {
+    fill(occ_.begin(), occ_.end(), 0);
+    const int r = rows_ / 2, c = cols_ / 2;
+    for (int i = 0; i < LANES; ++i) {
+        // Snake::reset: horizontal length 3 moving right, head at (r, c + 1)
+        Point* ring = &ring_[(size_t)i * cap_];
+        uint8_t* occ = &occ_[(size_t)i * cells_];
+        ring[0] = {r, c - 1};
+        ring[1] = {r, c};
+        ring[2] = {r, c + 1};
+        for (int k = 0; k < 3; ++k) {
+            Point p = ring[k];
+            if (p.r >= 0 && p.r < rows_ && p.c >= 0 && p.c < cols_) occ[p.r * cols_ + p.c] += 1;
+        }
+        ring_tail_[i] = 0;
+        ring_head_[i] = 2;
+        head_r_[i] = r; head_c_[i] = c + 1;
+        tail_r_[i] = r; tail_c_[i] = c - 1;
+        dir_[i] = D_RIGHT;
+        grow_[i] = 0;
+        score_[i] = 0;
+        alive_[i] = -1;
+        rng_[i] = seeds[i] ? seeds[i] : 1u;
+        spawn_food(i);
+    }
+}
+
+int BatchSim::step() {
+    Tick t;
+    Lanes s{head_r_, head_c_, dir_, food_r_, food_c_, tail_r_, tail_c_, grow_, alive_,
+            occ_.data(), rows_, cols_, cells_};
+#ifdef SNAKE_TERRA_HAVE_AVX2_KERNEL
+    if (uses_avx2()) kernel_avx2(s, t.nr, t.nc, t.dead, t.ate);
+    else kernel_generic(s, t.nr, t.nc, t.dead, t.ate);
+#else
+    kernel_generic(s, t.nr, t.nc, t.dead, t.ate);
+#endif
+    commit(t);
+    int live = 0;
+    for (int i = 0; i < LANES; ++i) live += alive_[i] ? 1 : 0;
+    return live;
+}
+
+void BatchSim::run(const unsigned* seeds, int max_ticks) {
+    reset(seeds);
+    for (int t = 0; t < max_ticks; ++t) {
+        if (step() == 0) break;
+    }
+}
+
+// Body ring, occupancy and food are per-lane scatter work; the kernel has
+// already decided what happens to each lane.
+void BatchSim::commit(const Tick& t) {
+    for (int i = 0; i < LANES; ++i) {
+        if (!alive_[i]) continue;
+        if (t.dead[i]) { alive_[i] = 0; continue; }
+        Point* ring = &ring_[(size_t)i * cap_];
+        uint8_t* occ = &occ_[(size_t)i * cells_];
+
+        if (++ring_head_[i] == cap_) ring_head_[i] = 0;
+        ring[ring_head_[i]] = {t.nr[i], t.nc[i]};
+        occ[t.nr[i] * cols_ + t.nc[i]] += 1;
+        head_r_[i] = t.nr[i];
+        head_c_[i] = t.nc[i];
+        if (grow_[i]) {
+            grow_[i] = 0;
+        } else {
+            Point tail = ring[ring_tail_[i]];
+            if (tail.r >= 0 && tail.r < rows_ && tail.c >= 0 && tail.c < cols_) occ[tail.r * cols_ + tail.c] -= 1;
+            if (++ring_tail_[i] == cap_) ring_tail_[i] = 0;
+        }
+        tail_r_[i] = ring[ring_tail_[i]].r;
+        tail_c_[i] = ring[ring_tail_[i]].c;
+
+        if (t.ate[i]) {
+            score_[i] += 1;
+            grow_[i] = -1;
+            spawn_food(i);
+        }
+    }
+}
+
+// Food::spawn with a Food::next_pick draw, scanning the occupancy grid.
+void BatchSim::spawn_food(int lane) {
+    unsigned pick = Food::next_pick(rng_[lane]);
+    const uint8_t* occ = &occ_[(size_t)lane * cells_];
+    int empties = 0;
+    for (int k = 0; k < cells_; ++k) empties += occ[k] ? 0 : 1;
+    if (empties == 0) {
+        food_r_[lane] = food_c_[lane] = -1;
+        return;
+    }
+    int n = (int)(pick % (unsigned)empties);
+    for (int k = 0; k < cells_; ++k) {
+        if (occ[k]) continue;
+        if (n-- == 0) {
+            food_r_[lane] = k / cols_;
+            food_c_[lane] = k % cols_;
+            return;
+        }
+    }
+}
+
+int BatchSim::score(int lane) const { return score_[lane]; }
+bool BatchSim::alive(int lane) const { return alive_[lane] != 0; }
+
+} // namespace snaketerra
@@ -0,0 +1,133 @@
+#include "Bench.h"
+#include "BatchSim.h"
+#include "GameBoard.h"
+#include "Leaderboard.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace snaketerra {
+
+namespace {
+
+struct BoardSize { int rows; int cols; int games; };
+
+double seconds_since(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int run_bench(int rounds) {
+    if (rounds < 1) rounds = 1;
+    static const BoardSize sizes[] = {
+        {10, 10, 400}, {20, 30, 200}, {40, 60, 40}, {60, 80, 15}
+    };
+    const string lb_path = "bench_leaderboard.txt";
+    remove(lb_path.c_str());
+    Leaderboard::drop_shared(lb_path);
+
+    // keep the player's leaderboard (and its shared segment) out of the bench
+    GameBoard gb(20, 30, lb_path);
+    double total = 0.0;
+    long long checksum = 0;
+
+    for (const auto& sz : sizes) {
+        srand(12345u + (unsigned)sz.rows);
+        auto t0 = chrono::steady_clock::now();
+        long long score = 0;
+        for (int r = 0; r < rounds; ++r) {
+            for (int g = 0; g < sz.games; ++g) {
+                score += gb.simulate(sz.rows, sz.cols, sz.rows * sz.cols * 8);
+            }
+        }
+        double dt = seconds_since(t0);
+        total += dt;
+        checksum += score;
+        printf("games %dx%d: %d games, score %lld, %.3f s\n",
+               sz.rows, sz.cols, sz.games * rounds, score, dt);
+    }
+
+    // Same seeded games stepped one at a time vs. BatchSim::LANES in lockstep.
+    static const BoardSize lockstep_sizes[] = { {20, 30, 256}, {40, 60, 64} };
+    const int lanes = BatchSim::LANES;
+    for (const auto& sz : lockstep_sizes) {
+        const int max_ticks = sz.rows * sz.cols * 8;
+        vector<int> scalar_scores(sz.games), batch_scores(sz.games);
+
+        auto t0 = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            for (int g = 0; g < sz.games; ++g) {
+                scalar_scores[g] = gb.simulate(sz.rows, sz.cols, max_ticks, 1000u + (unsigned)g);
+            }
+        }
+        double dt_scalar = seconds_since(t0);
+
+        // The generic lane loop shares the SoA layout and occupancy grid with
+        // the AVX2 kernel, so generic vs. avx2 isolates the vectorisation gain.
+        BatchSim sim(sz.rows, sz.cols);
+        auto run_batch = [&](bool generic) {
+            BatchSim::force_generic(generic);
+            auto tb = chrono::steady_clock::now();
+            for (int r = 0; r < rounds; ++r) {
+                for (int g = 0; g < sz.games; g += lanes) {
+                    unsigned seeds[BatchSim::LANES];
+                    for (int i = 0; i < lanes; ++i) seeds[i] = 1000u + (unsigned)(g + i);
+                    sim.run(seeds, max_ticks);
+                    for (int i = 0; i < lanes && g + i < sz.games; ++i) batch_scores[g + i] = sim.score(i);
+                }
+            }
+            BatchSim::force_generic(false);
+            int mismatches = 0;
+            for (int g = 0; g < sz.games; ++g) mismatches += scalar_scores[g] != batch_scores[g];
+            return make_pair(seconds_since(tb), mismatches);
+        };
+
+        auto generic = run_batch(true);
+        double dt_generic = generic.first;
+        int mismatches = generic.second;
+        total += dt_scalar + dt_generic;
+        printf("lockstep %dx%d: %d games, one-at-a-time %.3f s, %d-lane generic %.3f s (%.2fx)",
+               sz.rows, sz.cols, sz.games * rounds, dt_scalar, lanes, dt_generic,
+               dt_generic > 0 ? dt_scalar / dt_generic : 0.0);
+        if (BatchSim::uses_avx2()) {
+            auto avx2 = run_batch(false);
+            total += avx2.first;
+            mismatches += avx2.second;
+            printf(", %d-lane avx2 %.3f s (%.2fx over generic)", lanes, avx2.first,
+                   avx2.first > 0 ? dt_generic / avx2.first : 0.0);
+        }
+        printf(", %d mismatches\n", mismatches);
+        if (mismatches) return 1;
+    }
+
+    {
+        auto t0 = chrono::steady_clock::now();
+        Leaderboard lb(lb_path);
+        for (int r = 0; r < rounds; ++r) {
+            for (int i = 0; i < 100; ++i) {
+                lb.add("bench" + to_string(i % 37), (i * 7919 + r * 31) % 500);
+            }
+            lb.load();
+            lb.save();
+        }
+        double dt = seconds_since(t0);
+        total += dt;
+        checksum += lb.top(1).empty() ? 0 : lb.top(1)[0].score;
+        printf("leaderboard: %d adds, %.3f s\n", rounds * 100, dt);
+    }
+    remove(lb_path.c_str());
+    remove((lb_path + ".lock").c_str());
+    Leaderboard::drop_shared(lb_path);
+
+    printf("checksum %lld\n", checksum);
+    printf("total_seconds %.6f\n", total);
+    return 0;
+}
+
+} // namespace snaketerra
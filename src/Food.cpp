@@ -1,5 +1,6 @@
 #include "Food.h"
 #include "Snake.h"
+#include "Trace.h"
 #include <vector>
 #include <cstdlib>
 
@@ -12,6 +13,11 @@ Food::Food() : pos_{-1, -1} {}
 Point Food::pos() const { return pos_; }
 
 void Food::spawn(int rows, int cols, const Snake& snake) {
+    spawn(rows, cols, snake, (unsigned)rand());
+}
+
+void Food::spawn(int rows, int cols, const Snake& snake, unsigned pick) {
+    TRACE_SCOPE("Food::spawn");
     vector<Point> empties;
     empties.reserve(rows * cols);
     for (int r = 0; r < rows; ++r) {
@@ -24,7 +30,14 @@ void Food::spawn(int rows, int cols, const Snake& snake) {
         pos_ = {-1, -1};
         return;
     }
-    pos_ = empties[rand() % empties.size()];
+    pos_ = empties[pick % empties.size()];
+}
+
+unsigned Food::next_pick(unsigned& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
 }
 
 } // namespace snaketerra
\ No newline at end of file
@@ -1,17 +1,20 @@
 #include "GameBoard.h"
+#include "Trace.h"
 #include <ncurses.h>
 #include <chrono>
 #include <thread>
 #include <algorithm>
 #include <cstring>
 #include <vector>
+#include <clocale>
+#include <langinfo.h>
 
 using namespace std;
 using namespace std::chrono_literals;
 
 namespace snaketerra {
 
-GameBoard::GameBoard(int rows, int cols)
+GameBoard::GameBoard(int rows, int cols, const string& leaderboard_path)
     : rows_(rows),
       cols_(cols),
       snake_(),
@@ -19,8 +22,18 @@ GameBoard::GameBoard(int rows, int cols)
       score_(0),
       running_(false),
       cell_w_(2), // keep cell width fixed
-      leaderboard_("leaderboard.txt"),
+      half_block_(false),
+      leaderboard_(leaderboard_path),
       difficulty_(Difficulty::NORMAL),
+      food_seed_(0),
+      menu_win_(nullptr),
+      popup_win_(nullptr),
+      prompt_win_(nullptr),
+      game_over_win_(nullptr),
+      board_win_(nullptr),
+      info_win_(nullptr),
+      info_score_win_(nullptr),
+      info_top3_win_(nullptr),
       play_rows_(rows),
       play_cols_(cols)
 {
@@ -30,7 +43,17 @@ GameBoard::GameBoard(int rows, int cols)
 
 GameBoard::~GameBoard() = default;
 
+// Half-block cell kinds and the colour pairs used to draw them
+static const unsigned char CELL_EMPTY = 0, CELL_SNAKE = 1, CELL_FOOD = 2;
+static const int HALF_PAIR_BASE = 6; // pair = base + (fg - 1) * 3 + bg
+
+void GameBoard::set_half_block(bool on) { half_block_ = on; }
+
 void GameBoard::init_ncurses() {
+    setlocale(LC_ALL, "");
+    if (half_block_ && !terminal_supports_utf8()) half_block_ = false;
+    cell_w_ = half_block_ ? 1 : 2;
+
     initscr();
     cbreak();
     noecho();
@@ -45,29 +68,64 @@ void GameBoard::init_ncurses() {
         init_pair(3, COLOR_WHITE, -1); // borders / text
         init_pair(4, COLOR_YELLOW, -1); // highlights
         init_pair(5, COLOR_CYAN, -1); // menu / banner
+        // half-block pairs: foreground is snake/food, background any kind
+        const short kind_color[] = {-1, COLOR_GREEN, COLOR_RED};
+        for (int fg = CELL_SNAKE; fg <= CELL_FOOD; ++fg)
+            for (int bg = CELL_EMPTY; bg <= CELL_FOOD; ++bg)
+                init_pair(HALF_PAIR_BASE + (fg - 1) * 3 + bg, kind_color[fg], kind_color[bg]);
     }
 }
 
 void GameBoard::shutdown_ncurses() {
+    destroy_windows();
     nodelay(stdscr, FALSE);
     getch();
     endwin();
 }
 
+// One flat loop: restarts and menu round-trips never nest calls.
 void GameBoard::run() {
-    while (true) {
-        int choice = show_main_menu();
-        if (choice == 0) {
-            play_game();
-        } else if (choice == 1) {
-            change_difficulty_screen();
-        } else if (choice == 2) {
-            show_leaderboard_screen();
-        } else {
-            shutdown_ncurses();
-            return;
+    Scene scene = Scene::MENU;
+    while (scene != Scene::QUIT) {
+        switch (scene) {
+            case Scene::MENU:        scene = show_main_menu(); break;
+            case Scene::PLAY:        scene = play_game(); break;
+            case Scene::GAME_OVER:   scene = show_game_over_screen(); break;
+            case Scene::LEADERBOARD: scene = show_leaderboard_screen(); break;
+            case Scene::DIFFICULTY:  scene = change_difficulty_screen(); break;
+            case Scene::QUIT:        break;
         }
     }
+    shutdown_ncurses();
+}
+
+WINDOW* GameBoard::place_win(WINDOW*& slot, int h, int w, int y, int x) {
+    if (!slot) {
+        slot = newwin(h, w, y, x);
+    } else {
+        if (getmaxy(slot) != h || getmaxx(slot) != w) wresize(slot, h, w);
+        if (getbegy(slot) != y || getbegx(slot) != x) mvwin(slot, y, x);
+    }
+    return slot;
+}
+
+WINDOW* GameBoard::place_subwin(WINDOW*& slot, WINDOW* parent, int h, int w, int y, int x) {
+    if (!slot) {
+        slot = derwin(parent, h, w, y, x);
+    } else {
+        if (getmaxy(slot) != h || getmaxx(slot) != w) wresize(slot, h, w);
+        mvderwin(slot, y, x);
+    }
+    return slot;
+}
+
+void GameBoard::destroy_windows() {
+    // subwindows before their parent
+    WINDOW** wins[] = {&info_top3_win_, &info_score_win_, &info_win_, &board_win_,
+                       &game_over_win_, &prompt_win_, &popup_win_, &menu_win_};
+    for (WINDOW** w : wins) {
+        if (*w) { delwin(*w); *w = nullptr; }
+    }
 }
 
 // draw a big "SNAKE TERRA" made of '#' characters into the provided window
@@ -114,7 +172,8 @@ void GameBoard::draw_banner_to_win(void* win_ptr, int start_y, int max_w) {
     }
 }
 
-int GameBoard::show_main_menu() {
+Scene GameBoard::show_main_menu() {
+    static const Scene targets[] = {Scene::PLAY, Scene::DIFFICULTY, Scene::LEADERBOARD, Scene::QUIT};
     const vector<string> items = {
         "Start Game",
         "Change Difficulty",
@@ -130,7 +189,7 @@ int GameBoard::show_main_menu() {
     clear();
     refresh();
 
-    WINDOW* menu_win = newwin(menu_h, menu_w, sy, sx);
+    WINDOW* menu_win = place_win(menu_win_, menu_h, menu_w, sy, sx);
     keypad(menu_win, TRUE);
     int choice = 0;
     while (true) {
@@ -153,13 +212,13 @@ int GameBoard::show_main_menu() {
         int ch = wgetch(menu_win);
         if (ch == KEY_UP) choice = (choice - 1 + (int)items.size()) % (int)items.size();
         else if (ch == KEY_DOWN) choice = (choice + 1) % (int)items.size();
-        else if (ch == '\n' || ch == KEY_ENTER) { delwin(menu_win); return choice; }
-        else if (ch == 'q' || ch == 'Q') { delwin(menu_win); return (int)items.size() - 1; }
+        else if (ch == '\n' || ch == KEY_ENTER) return targets[choice];
+        else if (ch == 'q' || ch == 'Q') return Scene::QUIT;
         this_thread::sleep_for(40ms);
     }
 }
 
-void GameBoard::show_leaderboard_screen() {
+Scene GameBoard::show_leaderboard_screen() {
     leaderboard_.load();
     int h = min(LINES - 4, 20);
     int w = min(COLS - 8, 60);
@@ -169,25 +228,27 @@ void GameBoard::show_leaderboard_screen() {
     clear();
     refresh();
 
-    WINDOW* win = newwin(h, w, sy, sx);
+    WINDOW* win = place_win(popup_win_, h, w, sy, sx);
     keypad(win, TRUE);
+    werase(win);
     box(win, 0, 0);
     mvwprintw(win, 1, 2, "Leaderboards (top entries)");
-    auto all = leaderboard_.all();
+    const auto& all = leaderboard_.all();
     if (all.empty()) mvwprintw(win, 3, 4, "No scores yet.");
     else {
         for (size_t i = 0; i < all.size() && i < (size_t)(h - 6); ++i) {
-            mvwprintw(win, 3 + (int)i, 4, "%2zu. %-16s %6d", i + 1, all[i].name.c_str(), all[i].score);
+            string diff = all[i].difficulty ? difficulty_to_string((Difficulty)all[i].difficulty) : "";
+            mvwprintw(win, 3 + (int)i, 4, "%2zu. %-16s %6d  %s", i + 1, leaderboard_.name(all[i]), all[i].score, diff.c_str());
         }
     }
     mvwprintw(win, h - 2, 2, "Press any key to go back.");
     wrefresh(win);
     nodelay(win, FALSE);
     wgetch(win);
-    delwin(win);
+    return Scene::MENU;
 }
 
-void GameBoard::change_difficulty_screen() {
+Scene GameBoard::change_difficulty_screen() {
     vector<Difficulty> diffs = {Difficulty::EASY, Difficulty::NORMAL, Difficulty::HARD};
     int idx = 1;
     for (size_t i = 0; i < diffs.size(); ++i) if (diffs[i] == difficulty_) idx = (int)i;
@@ -198,7 +259,7 @@ void GameBoard::change_difficulty_screen() {
     clear();
     refresh();
 
-    WINDOW* win = newwin(h, w, sy, sx);
+    WINDOW* win = place_win(popup_win_, h, w, sy, sx);
     keypad(win, TRUE);
     while (true) {
         werase(win); box(win, 0, 0);
@@ -212,28 +273,34 @@ void GameBoard::change_difficulty_screen() {
         int ch = wgetch(win);
         if (ch == KEY_LEFT) idx = (idx - 1 + (int)diffs.size()) % (int)diffs.size();
         else if (ch == KEY_RIGHT) idx = (idx + 1) % (int)diffs.size();
-        else if (ch == '\n' || ch == KEY_ENTER) { difficulty_ = diffs[idx]; delwin(win); return; }
-        else if (ch == 27) { delwin(win); return; } // ESC
+        else if (ch == '\n' || ch == KEY_ENTER) { difficulty_ = diffs[idx]; return Scene::MENU; }
+        else if (ch == 27) return Scene::MENU; // ESC
         this_thread::sleep_for(30ms);
     }
 }
 
-void GameBoard::play_game() {
+Scene GameBoard::play_game() {
     // Clear the screen when the game opens
     clear();
     refresh();
 
     // Fixed-size play box (independent of terminal size).
-    const int used_cell_w = cell_w_; // fixed 2 characters per cell
+    const int used_cell_w = cell_w_; // 2 characters per cell, 1 in half-block mode
     const int left_box_w = cols_ * used_cell_w + 2; // +2 for box borders
-    const int left_box_h = rows_ + 2;                // +2 for box borders
+    const int left_box_h = (half_block_ ? (rows_ + 1) / 2 : rows_) + 2; // +2 for box borders
 
+    // The info column only needs room for its own boxes, so a short
+    // half-block board box keeps the whole layout short: the score box takes
+    // rows 1-7 and the boxed Top 3 (3 entries + 2 borders) gets info_h - 10
+    // = 5 rows from row 8.
     const int info_w = max(28, COLS / 4);
+    const int info_h = max(left_box_h, 15);
     const int total_required_w = left_box_w + info_w + 6; // spacing + margins
-    const int total_required_h = left_box_h + 4;
+    const int total_required_h = max(left_box_h, info_h) + 4;
 
     if (COLS < total_required_w || LINES < total_required_h) {
-        WINDOW* w = newwin(6, 70, (LINES - 6) / 2, max(2, (COLS - 70) / 2));
+        WINDOW* w = place_win(popup_win_, 6, 70, (LINES - 6) / 2, max(2, (COLS - 70) / 2));
+        werase(w);
         box(w, 0, 0);
         mvwprintw(w, 1, 2, "Terminal too small for fixed-size game box.");
         mvwprintw(w, 2, 2, "Required: at least %d cols x %d rows. Current: %d x %d.",
@@ -242,8 +309,7 @@ void GameBoard::play_game() {
         wrefresh(w);
         nodelay(w, FALSE);
         wgetch(w);
-        delwin(w);
-        return;
+        return Scene::MENU;
     }
 
     score_ = 0;
@@ -252,13 +318,13 @@ void GameBoard::play_game() {
     const int left = 2;
     const int right_box_x = left + left_box_w + 2;
 
-    WINDOW* left_win = newwin(left_box_h, left_box_w, top, left);
-    WINDOW* right_win = newwin(left_box_h, info_w, top, right_box_x);
+    WINDOW* left_win = place_win(board_win_, left_box_h, left_box_w, top, left);
+    WINDOW* right_win = place_win(info_win_, info_h, info_w, top, right_box_x);
     keypad(left_win, TRUE);
     keypad(right_win, TRUE);
 
-    WINDOW* right_score = derwin(right_win, 7, info_w - 2, 1, 1);
-    WINDOW* right_top3 = derwin(right_win, left_box_h - 10, info_w - 2, 8, 1);
+    WINDOW* right_score = place_subwin(info_score_win_, right_win, 7, info_w - 2, 1, 1);
+    WINDOW* right_top3 = place_subwin(info_top3_win_, right_win, info_h - 10, info_w - 2, 8, 1);
 
     play_cols_ = cols_;
     play_rows_ = rows_;
@@ -283,74 +349,124 @@ void GameBoard::play_game() {
             last_tick = now;
         }
 
-        werase(left_win);
-        box(left_win, 0, 0);
-        mvwprintw(left_win, 0, 2, " Game ");
-
-        Point f = food_.pos();
-        if (f.r >= 0 && f.c >= 0 && f.r < play_rows_ && f.c < play_cols_) {
-            wattron(left_win, COLOR_PAIR(2));
-            mvwprintw(left_win, 1 + f.r, 1 + f.c * used_cell_w, "%s", "<>");
-            wattroff(left_win, COLOR_PAIR(2));
-        }
+        {
+            TRACE_SCOPE("render");
+            werase(left_win);
+            box(left_win, 0, 0);
+            mvwprintw(left_win, 0, 2, " Game ");
 
-        for (const auto& seg : snake_.body()) {
-            if (seg.r < 0 || seg.r >= play_rows_) continue;
-            if (seg.c < 0 || seg.c >= play_cols_) continue;
-            wattron(left_win, COLOR_PAIR(1));
-            if (used_cell_w == 1) {
-                mvwaddch(left_win, 1 + seg.r, 1 + seg.c * used_cell_w, ' ' | A_REVERSE);
+            if (half_block_) {
+                draw_board_half_block(reinterpret_cast<struct _win_st*>(left_win));
             } else {
-                mvwaddstr(left_win, 1 + seg.r, 1 + seg.c * used_cell_w, "  ");
+                Point f = food_.pos();
+                if (f.r >= 0 && f.c >= 0 && f.r < play_rows_ && f.c < play_cols_) {
+                    wattron(left_win, COLOR_PAIR(2));
+                    mvwprintw(left_win, 1 + f.r, 1 + f.c * used_cell_w, "%s", "<>");
+                    wattroff(left_win, COLOR_PAIR(2));
+                }
+
+                for (const auto& seg : snake_.body()) {
+                    if (seg.r < 0 || seg.r >= play_rows_) continue;
+                    if (seg.c < 0 || seg.c >= play_cols_) continue;
+                    wattron(left_win, COLOR_PAIR(1));
+                    if (used_cell_w == 1) {
+                        mvwaddch(left_win, 1 + seg.r, 1 + seg.c * used_cell_w, ' ' | A_REVERSE);
+                    } else {
+                        mvwaddstr(left_win, 1 + seg.r, 1 + seg.c * used_cell_w, "  ");
+                    }
+                    wattroff(left_win, COLOR_PAIR(1));
+                }
             }
-            wattroff(left_win, COLOR_PAIR(1));
-        }
-        wrefresh(left_win);
-
-        werase(right_win);
-        box(right_win, 0, 0);
-        mvwprintw(right_win, 0, 2, " Info ");
-
-        werase(right_score);
-        box(right_score, 0, 0);
-        mvwprintw(right_score, 0, 2, " Current ");
-        wattron(right_score, COLOR_PAIR(4));
-        mvwprintw(right_score, 1, 2, "Score: %d", score_);
-        mvwprintw(right_score, 2, 2, "Difficulty: %s", difficulty_str().c_str());
-        mvwprintw(right_score, 3, 2, "Length: %zu", snake_.body().size());
-        wattroff(right_score, COLOR_PAIR(4));
-        wrefresh(right_score);
-
-        werase(right_top3);
-        box(right_top3, 0, 0);
-        mvwprintw(right_top3, 0, 2, " Top 3 ");
-        auto t3 = leaderboard_.top(3);
-        if (t3.empty()) {
-            mvwprintw(right_top3, 1, 2, "No scores yet.");
-        } else {
-            for (size_t i = 0; i < t3.size(); ++i) {
-                mvwprintw(right_top3, 1 + (int)i, 2, "%d) %-12s %6d", (int)i + 1, t3[i].name.c_str(), t3[i].score);
+            wrefresh(left_win);
+
+            werase(right_win);
+            box(right_win, 0, 0);
+            mvwprintw(right_win, 0, 2, " Info ");
+
+            werase(right_score);
+            box(right_score, 0, 0);
+            mvwprintw(right_score, 0, 2, " Current ");
+            wattron(right_score, COLOR_PAIR(4));
+            mvwprintw(right_score, 1, 2, "Score: %d", score_);
+            mvwprintw(right_score, 2, 2, "Difficulty: %s", difficulty_str().c_str());
+            mvwprintw(right_score, 3, 2, "Length: %zu", snake_.body().size());
+            wattroff(right_score, COLOR_PAIR(4));
+            wrefresh(right_score);
+
+            werase(right_top3);
+            box(right_top3, 0, 0);
+            mvwprintw(right_top3, 0, 2, " Top 3 ");
+            auto t3 = leaderboard_.top(3);
+            if (t3.empty()) {
+                mvwprintw(right_top3, 1, 2, "No scores yet.");
+            } else {
+                for (size_t i = 0; i < t3.size(); ++i) {
+                    mvwprintw(right_top3, 1 + (int)i, 2, "%d) %-12s %6d", (int)i + 1, leaderboard_.name(t3[i]), t3[i].score);
+                }
             }
+            wrefresh(right_top3);
+            wrefresh(right_win);
         }
-        wrefresh(right_top3);
-        wrefresh(right_win);
 
         delay_ms = max(30, static_cast<int>(difficulty_) - score_ * 2);
         this_thread::sleep_for(8ms);
     }
 
-    delwin(right_top3);
-    delwin(right_score);
-    delwin(right_win);
-    delwin(left_win);
-
     nodelay(stdscr, FALSE);
-    string name = prompt_name_and_save();
-    leaderboard_.add(name, score_);
-    show_game_over_screen(name);
+    last_name_ = prompt_name_and_save();
+    leaderboard_.add(last_name_, score_, static_cast<int>(difficulty_));
+    return Scene::GAME_OVER;
+}
+
+// Each terminal row holds board rows 2y (upper half) and 2y+1 (lower half) at
+// one column per cell. Adjacent cells with the same glyph and colour pair are
+// merged into one span so a frame costs one attribute switch per run.
+void GameBoard::draw_board_half_block(struct _win_st* win) {
+    WINDOW* w = reinterpret_cast<WINDOW*>(win);
+    cells_.assign((size_t)play_rows_ * play_cols_, CELL_EMPTY);
+    Point f = food_.pos();
+    if (f.r >= 0 && f.c >= 0 && f.r < play_rows_ && f.c < play_cols_)
+        cells_[(size_t)f.r * play_cols_ + f.c] = CELL_FOOD;
+    for (const auto& seg : snake_.body()) {
+        if (seg.r < 0 || seg.r >= play_rows_) continue;
+        if (seg.c < 0 || seg.c >= play_cols_) continue;
+        cells_[(size_t)seg.r * play_cols_ + seg.c] = CELL_SNAKE;
+    }
+
+    static const char* const UPPER = "\u2580"; // ▀
+    static const char* const LOWER = "\u2584"; // ▄
+    string span;
+    for (int y = 0; y * 2 < play_rows_; ++y) {
+        const unsigned char* top = &cells_[(size_t)(y * 2) * play_cols_];
+        const unsigned char* bot = (y * 2 + 1 < play_rows_) ? top + play_cols_ : nullptr;
+        int run_start = 0, run_pair = 0;
+        const char* run_glyph = nullptr;
+        for (int c = 0; c <= play_cols_; ++c) {
+            int pair = 0;
+            const char* glyph = nullptr;
+            if (c < play_cols_) {
+                unsigned char t = top[c];
+                unsigned char b = bot ? bot[c] : CELL_EMPTY;
+                if (t != CELL_EMPTY) { glyph = UPPER; pair = HALF_PAIR_BASE + (t - 1) * 3 + b; }
+                else if (b != CELL_EMPTY) { glyph = LOWER; pair = HALF_PAIR_BASE + (b - 1) * 3 + CELL_EMPTY; }
+            }
+            if (pair == run_pair && glyph == run_glyph) continue;
+            if (run_glyph) {
+                span.clear();
+                for (int k = run_start; k < c; ++k) span += run_glyph;
+                wattron(w, COLOR_PAIR(run_pair));
+                mvwaddstr(w, 1 + y, 1 + run_start, span.c_str());
+                wattroff(w, COLOR_PAIR(run_pair));
+            }
+            run_start = c;
+            run_pair = pair;
+            run_glyph = glyph;
+        }
+    }
 }
 
 void GameBoard::step() {
+    TRACE_SCOPE("GameBoard::step");
     snake_.move();
     Point h = snake_.head();
     if (h.r < 0 || h.r >= play_rows_ || h.c < 0 || h.c >= play_cols_) { running_ = false; return; }
@@ -358,10 +474,60 @@ void GameBoard::step() {
     if (h == food_.pos()) {
         score_ += 1;
         snake_.grow();
-        food_.spawn(play_rows_, play_cols_, snake_);
+        spawn_food();
     }
 }
 
+void GameBoard::spawn_food() {
+    if (food_seed_) food_.spawn(play_rows_, play_cols_, snake_, Food::next_pick(food_seed_));
+    else food_.spawn(play_rows_, play_cols_, snake_);
+}
+
+int GameBoard::simulate(int rows, int cols, int max_ticks, unsigned seed) {
+    play_rows_ = rows;
+    play_cols_ = cols;
+    score_ = 0;
+    food_seed_ = seed;
+    snake_.reset(play_rows_ / 2, play_cols_ / 2);
+    spawn_food();
+    running_ = true;
+    for (int t = 0; t < max_ticks && running_; ++t) {
+        snake_.set_dir(autopilot_dir());
+        step();
+    }
+    running_ = false;
+    food_seed_ = 0;
+    return score_;
+}
+
+// Greedy autopilot: head toward the food, otherwise take any safe turn.
+Dir GameBoard::autopilot_dir() const {
+    Point h = snake_.head();
+    Point f = food_.pos();
+    Dir cur = snake_.dir();
+    const Dir candidates[] = {
+        f.r < h.r ? Dir::UP : Dir::DOWN,
+        f.c < h.c ? Dir::LEFT : Dir::RIGHT,
+        cur, Dir::UP, Dir::DOWN, Dir::LEFT, Dir::RIGHT
+    };
+    for (int i = 0; i < 7; ++i) {
+        Dir d = candidates[i];
+        if (i == 0 && f.r == h.r) continue;
+        if (i == 1 && f.c == h.c) continue;
+        Point n = h;
+        switch (d) {
+            case Dir::UP:    n.r -= 1; if (cur == Dir::DOWN) continue; break;
+            case Dir::DOWN:  n.r += 1; if (cur == Dir::UP) continue; break;
+            case Dir::LEFT:  n.c -= 1; if (cur == Dir::RIGHT) continue; break;
+            case Dir::RIGHT: n.c += 1; if (cur == Dir::LEFT) continue; break;
+        }
+        if (n.r < 0 || n.r >= play_rows_ || n.c < 0 || n.c >= play_cols_) continue;
+        if (snake_.occupies(n)) continue;
+        return d;
+    }
+    return cur;
+}
+
 void GameBoard::handle_input(int ch) {
     switch (ch) {
         case KEY_UP: case 'w': case 'W': snake_.set_dir(Dir::UP); break;
@@ -385,7 +551,8 @@ string GameBoard::prompt_name_and_save() {
     echo(); curs_set(1);
     int wy = LINES / 2 - 2;
     int wx = max(2, (COLS - 60) / 2);
-    WINDOW* w = newwin(6, 60, wy, wx);
+    WINDOW* w = place_win(prompt_win_, 6, 60, wy, wx);
+    werase(w);
     box(w, 0, 0);
     mvwprintw(w, 1, 2, "Game Over! Your score: %d", score_);
     mvwprintw(w, 2, 2, "Enter your name (alnum, max 16). Press Enter to save:");
@@ -395,38 +562,34 @@ string GameBoard::prompt_name_and_save() {
     wgetnstr(w, buf, 32);
     string name(buf);
     if (name.empty()) name = "Player";
-    delwin(w);
     noecho(); curs_set(0);
     return name;
 }
 
-void GameBoard::show_game_over_screen(const string& name) {
+Scene GameBoard::show_game_over_screen() {
     int h = 12, w = 60;
     int sy = (LINES - h) / 2, sx = (COLS - w) / 2;
-    WINDOW* win = newwin(h, w, sy, sx);
+    WINDOW* win = place_win(game_over_win_, h, w, sy, sx);
+    werase(win);
     box(win, 0, 0);
     mvwprintw(win, 1, 2, "Game Over!");
-    mvwprintw(win, 2, 2, "Final Score for %s: %d", name.c_str(), score_);
+    mvwprintw(win, 2, 2, "Final Score for %s: %d", last_name_.c_str(), score_);
+    // best() is -1 when this score missed the leaderboard cut and the player
+    // has no stored record; the game just played still counts
+    mvwprintw(win, 3, 2, "Personal best: %d", max(leaderboard_.best(last_name_), score_));
     mvwprintw(win, 4, 2, "Top Scores:");
     auto top = leaderboard_.top(5);
     for (size_t i = 0; i < top.size() && i < (size_t)(h - 7); ++i) {
-        mvwprintw(win, 6 + (int)i, 4, "%2zu. %-12s %6d", i + 1, top[i].name.c_str(), top[i].score);
+        mvwprintw(win, 6 + (int)i, 4, "%2zu. %-12s %6d", i + 1, leaderboard_.name(top[i]), top[i].score);
     }
     mvwprintw(win, h - 2, 2, "Press R to Restart, M for Menu, Q to Quit.");
     wrefresh(win);
     nodelay(win, FALSE);
     while (true) {
         int ch = wgetch(win);
-        if (ch == 'r' || ch == 'R') {
-            delwin(win);
-            running_ = true;
-            score_ = 0;
-            snake_.reset(play_rows_ / 2, play_cols_ / 2);
-            food_.spawn(play_rows_, play_cols_, snake_);
-            play_game();
-            return;
-        } else if (ch == 'm' || ch == 'M') { delwin(win); return; }
-        else if (ch == 'q' || ch == 'Q') { delwin(win); shutdown_ncurses(); exit(0); }
+        if (ch == 'r' || ch == 'R') return Scene::PLAY; // play_game() resets the round
+        else if (ch == 'm' || ch == 'M') return Scene::MENU;
+        else if (ch == 'q' || ch == 'Q') return Scene::QUIT;
     }
 }
 
@@ -434,6 +597,11 @@ string GameBoard::difficulty_str() const {
     return difficulty_to_string(difficulty_);
 }
 
+bool GameBoard::terminal_supports_utf8() {
+    const char* cs = nl_langinfo(CODESET);
+    return cs && (strcmp(cs, "UTF-8") == 0 || strcmp(cs, "utf8") == 0);
+}
+
 string GameBoard::difficulty_to_string(Difficulty d) {
     switch (d) {
         case Difficulty::EASY: return "Easy";
@@ -1,18 +1,142 @@
 #include "Leaderboard.h"
+#include "Trace.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
 namespace snaketerra {
 
-Leaderboard::Leaderboard(const string& path) : path_(path) { load(); }
+namespace {
+
+// Advisory lock on `<path>.lock` serialising writers of the file itself
+// (the leaderboard file is replaced by rename, so it cannot be locked).
+class FileLock {
+public:
+    explicit FileLock(const string& path) {
+        fd_ = open((path + ".lock").c_str(), O_RDWR | O_CREAT, SharedScores::file_mode(path));
+        if (fd_ < 0) fd_ = open((path + ".lock").c_str(), O_RDONLY);
+        if (fd_ >= 0) flock(fd_, LOCK_EX);
+    }
+    ~FileLock() {
+        if (fd_ >= 0) close(fd_); // releases the lock
+    }
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+private:
+    int fd_;
+};
+
+} // namespace
+
+Leaderboard::Leaderboard(const string& path) : path_(path), seen_version_(0) {
+    shared_.attach(path_, [this](ScoreTable& out) { read_file(out); });
+    load();
+}
 
 void Leaderboard::load() {
-    entries_.clear();
+    TRACE_SCOPE("Leaderboard::load");
+    if (shared_.attached()) {
+        seen_version_ = shared_.version();
+        shared_.read(table_);
+        return;
+    }
+    read_file(table_);
+}
+
+void Leaderboard::save() {
+    TRACE_SCOPE("Leaderboard::save");
+    if (shared_.attached()) {
+        // persist the latest shared table under the writer lock so a slower
+        // session cannot overwrite a newer file
+        shared_.update([this](ScoreTable& cur) {
+            FileLock lock(path_);
+            write_file(cur);
+        });
+        return;
+    }
+    // Every add() is already on disk; re-read under the lock so saving never
+    // drops scores other sessions wrote since our last load.
+    FileLock lock(path_);
+    read_file(table_);
+    write_file(table_);
+}
+
+void Leaderboard::add(const string& name, int score, int difficulty) {
+    TRACE_SCOPE("Leaderboard::add");
+    string clean = sanitize_name(name);
+    uint32_t now = (uint32_t)time(nullptr);
+    if (shared_.attached()) {
+        shared_.update([&](ScoreTable& cur) {
+            if (!cur.add(clean, score, difficulty, now)) return;
+            cur.sort_and_trim();
+            FileLock lock(path_);
+            write_file(cur);
+        });
+        refresh();
+        return;
+    }
+    // file-only: merge with whatever other sessions wrote, then persist
+    FileLock lock(path_);
+    read_file(table_);
+    if (!table_.add(clean, score, difficulty, now)) return;
+    table_.sort_and_trim();
+    write_file(table_);
+}
+
+vector<ScoreRecord> Leaderboard::top(int n) const {
+    refresh();
+    const auto& recs = table_.records();
+    size_t count = min(recs.size(), (size_t)max(n, 0));
+    return vector<ScoreRecord>(recs.begin(), recs.begin() + count);
+}
+
+const vector<ScoreRecord>& Leaderboard::all() const {
+    refresh();
+    return table_.records();
+}
+
+const char* Leaderboard::name(const ScoreRecord& r) const { return table_.name(r.player); }
+
+int Leaderboard::best(const string& name) const {
+    refresh();
+    uint16_t id = table_.find(sanitize_name(name));
+    return id == ScoreTable::NO_PLAYER ? -1 : table_.best(id);
+}
+
+vector<ScoreRecord> Leaderboard::history(const string& name) const {
+    refresh();
+    uint16_t id = table_.find(sanitize_name(name));
+    if (id == ScoreTable::NO_PLAYER) return {};
+    return table_.history(id);
+}
+
+void Leaderboard::drop_shared(const string& path) { SharedScores::remove(path); }
+
+// Re-copy the shared table only when another write has landed since.
+void Leaderboard::refresh() const {
+    if (!shared_.attached()) return;
+    uint32_t v = shared_.version();
+    if (v == seen_version_) return;
+    shared_.read(table_);
+    seen_version_ = v;
+}
+
+// Lines are `"name" score [difficulty time]`; older files have no
+// difficulty or time, and very old ones no quotes.
+void Leaderboard::read_file(ScoreTable& out) const {
+    out.clear();
     ifstream ifs(path_);
     if (!ifs) return;
     string line;
@@ -21,55 +145,66 @@ void Leaderboard::load() {
         istringstream iss(line);
         string name;
         int score;
+        int difficulty = 0;
+        unsigned long when = 0;
         if (iss >> quoted(name) >> score) {
-            entries_.push_back({name, score});
+            if (iss >> difficulty) iss >> when;
         } else {
             istringstream iss2(line);
-            if (iss2 >> name >> score) entries_.push_back({name, score});
+            if (!(iss2 >> name >> score)) continue;
         }
+        out.add(sanitize_name(name), score, difficulty, (uint32_t)when);
     }
-    sort_and_trim();
+    out.sort_and_trim();
 }
 
-void Leaderboard::save() {
-    ofstream ofs(path_, ios::trunc);
-    if (!ofs) return;
-    for (auto &e : entries_) {
-        ofs << quoted(e.name) << " " << e.score << "\n";
+// Write to a unique temp file and rename so readers never see a half-written
+// file. The replacement keeps the original file's permissions, and both it and
+// the directory entry are synced so a crash leaves the old or the new file.
+void Leaderboard::write_file(const ScoreTable& table) const {
+    ostringstream oss;
+    for (const auto& r : table.records()) {
+        oss << quoted(string(table.name(r.player))) << " " << r.score << " "
+            << (int)r.difficulty << " " << r.time << "\n";
     }
-}
-
-void Leaderboard::add(const string& name, int score) {
-    string clean = sanitize_name(name);
-    entries_.push_back({clean, score});
-    sort_and_trim();
-    save();
-}
-
-vector<ScoreEntry> Leaderboard::top(int n) const {
-    vector<ScoreEntry> out;
-    for (size_t i = 0; i < entries_.size() && (int)i < n; ++i) out.push_back(entries_[i]);
-    return out;
-}
+    const string data = oss.str();
 
-vector<ScoreEntry> Leaderboard::all() const { return entries_; }
+    string tmp = path_ + ".XXXXXX";
+    int fd = mkstemp(&tmp[0]);
+    if (fd < 0) return;
+    fchmod(fd, SharedScores::file_mode(path_));
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = write(fd, data.data() + done, data.size() - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        done += (size_t)n;
+    }
+    if (done < data.size() || fsync(fd) != 0) {
+        close(fd);
+        remove(tmp.c_str());
+        return;
+    }
+    close(fd);
+    if (rename(tmp.c_str(), path_.c_str()) != 0) { remove(tmp.c_str()); return; }
 
-void Leaderboard::sort_and_trim() {
-    sort(entries_.begin(), entries_.end(), [](const ScoreEntry& a, const ScoreEntry& b) {
-        if (a.score != b.score) return a.score > b.score;
-        return a.name < b.name;
-    });
-    if (entries_.size() > 200) entries_.resize(200);
+    size_t slash = path_.rfind('/');
+    string dir = slash == string::npos ? "." : (slash == 0 ? "/" : path_.substr(0, slash));
+    int dfd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dfd >= 0) {
+        fsync(dfd);
+        close(dfd);
+    }
 }
 
 string Leaderboard::sanitize_name(const string& s) {
     string out;
     for (char ch : s) {
         if (isalnum((unsigned char)ch) || ch == '_' || ch == '-') out.push_back(ch);
-        if (out.size() >= 16) break;
+        if (out.size() >= (size_t)ScoreTable::NAME_LEN) break;
     }
     if (out.empty()) out = "Player";
     return out;
 }
 
-} // namespace snaketerra
\ No newline at end of file
+} // namespace snaketerra
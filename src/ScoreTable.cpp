@@ -0,0 +1,155 @@
+#include "ScoreTable.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace snaketerra {
+
+namespace {
+const size_t MIN_INDEX_SIZE = 16; // power of two
+}
+
+ScoreTable::ScoreTable() = default;
+
+void ScoreTable::clear() {
+    names_.clear();
+    records_.clear();
+    index_.clear();
+}
+
+uint32_t ScoreTable::hash(const char* s, size_t n) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < n; ++i) { h ^= (unsigned char)s[i]; h *= 16777619u; }
+    return h;
+}
+
+// Slot holding `s`, or the empty slot where it would go. The index is
+// never more than half full, so an empty slot always exists.
+size_t ScoreTable::slot_for(const char* s, size_t n) const {
+    const size_t mask = index_.size() - 1;
+    size_t i = hash(s, n) & mask;
+    while (index_[i] != NO_PLAYER) {
+        const char* cand = names_[index_[i]].s;
+        if (strncmp(cand, s, n) == 0 && cand[n] == '\0') break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Make room in the index for one more name, doubling it as it fills.
+void ScoreTable::grow_index() {
+    if ((names_.size() + 1) * 2 > index_.size()) rebuild_index();
+}
+
+uint16_t ScoreTable::intern(const string& name) {
+    size_t n = min(name.size(), (size_t)NAME_LEN);
+    grow_index();
+    size_t slot = slot_for(name.data(), n);
+    if (index_[slot] != NO_PLAYER) return index_[slot];
+    if ((int)names_.size() >= MAX_PLAYERS) return NO_PLAYER;
+    Name nm{};
+    memcpy(nm.s, name.data(), n);
+    names_.push_back(nm);
+    index_[slot] = (uint16_t)(names_.size() - 1);
+    return index_[slot];
+}
+
+uint16_t ScoreTable::find(const string& name) const {
+    if (name.size() > (size_t)NAME_LEN || index_.empty()) return NO_PLAYER;
+    return index_[slot_for(name.data(), name.size())];
+}
+
+const char* ScoreTable::name(uint16_t id) const {
+    return id < names_.size() ? names_[id].s : "";
+}
+
+int ScoreTable::player_count() const { return (int)names_.size(); }
+
+void ScoreTable::append_name(const char* s) {
+    Name nm{};
+    strncpy(nm.s, s, NAME_LEN);
+    grow_index();
+    names_.push_back(nm);
+    size_t slot = slot_for(nm.s, strlen(nm.s));
+    if (index_[slot] == NO_PLAYER) index_[slot] = (uint16_t)(names_.size() - 1);
+}
+
+bool ScoreTable::before(int score_a, const char* name_a, int score_b, const char* name_b) const {
+    if (score_a != score_b) return score_a > score_b;
+    return strcmp(name_a, name_b) < 0;
+}
+
+bool ScoreTable::add(const string& name, int score, int difficulty, uint32_t time) {
+    if ((int)records_.size() >= MAX_RECORDS) {
+        sort_and_trim();
+        const ScoreRecord& last = records_.back();
+        string clipped = name.substr(0, NAME_LEN);
+        if (!before(score, clipped.c_str(), last.score, this->name(last.player))) return false;
+        records_.pop_back();
+    }
+    uint16_t id = intern(name);
+    if (id == NO_PLAYER) {
+        // at most MAX_RECORDS - 1 names are still referenced, so this frees one
+        compact();
+        id = intern(name);
+    }
+    records_.push_back({id, (uint8_t)difficulty, 0, (int32_t)score, time});
+    return true;
+}
+
+void ScoreTable::sort_and_trim() {
+    sort(records_.begin(), records_.end(), [this](const ScoreRecord& a, const ScoreRecord& b) {
+        return before(a.score, names_[a.player].s, b.score, names_[b.player].s);
+    });
+    if (records_.size() > (size_t)MAX_RECORDS) records_.resize(MAX_RECORDS);
+}
+
+void ScoreTable::compact() {
+    vector<uint16_t> remap(names_.size(), NO_PLAYER);
+    for (const auto& r : records_) remap[r.player] = 0;
+    vector<Name> kept;
+    kept.reserve(names_.size());
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (remap[i] == NO_PLAYER) continue;
+        remap[i] = (uint16_t)kept.size();
+        kept.push_back(names_[i]);
+    }
+    for (auto& r : records_) r.player = remap[r.player];
+    names_.swap(kept);
+    rebuild_index();
+}
+
+// Size the index for the current names plus one and re-insert them all.
+void ScoreTable::rebuild_index() {
+    size_t size = MIN_INDEX_SIZE;
+    while (size < (names_.size() + 1) * 2) size *= 2;
+    index_.assign(size, NO_PLAYER);
+    for (size_t i = 0; i < names_.size(); ++i) {
+        index_[slot_for(names_[i].s, strlen(names_[i].s))] = (uint16_t)i;
+    }
+}
+
+const vector<ScoreRecord>& ScoreTable::records() const { return records_; }
+vector<ScoreRecord>& ScoreTable::records() { return records_; }
+
+int ScoreTable::best(uint16_t player) const {
+    int out = -1;
+    for (const auto& r : records_) {
+        if (r.player == player && r.score > out) out = r.score;
+    }
+    return out;
+}
+
+vector<ScoreRecord> ScoreTable::history(uint16_t player) const {
+    vector<ScoreRecord> out;
+    for (const auto& r : records_) {
+        if (r.player == player) out.push_back(r);
+    }
+    stable_sort(out.begin(), out.end(), [](const ScoreRecord& a, const ScoreRecord& b) {
+        return a.time < b.time;
+    });
+    return out;
+}
+
+} // namespace snaketerra
@@ -0,0 +1,263 @@
+#include "SharedScores.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace snaketerra {
+
+namespace {
+
+const uint32_t SEGMENT_MAGIC = 0x534e4b34; // "SNK4"
+
+struct SharedName { char s[ScoreTable::NAME_LEN + 1]; };
+
+} // namespace
+
+struct SharedSegment {
+    uint32_t magic;
+    atomic<uint32_t> ready;  // set by the creator once the table is filled
+    atomic<uint32_t> locked; // writer is set up and held by the creator until ready
+    pthread_mutex_t writer;  // robust, process-shared
+    atomic<uint32_t> seq;    // seqlock: odd while a write is in progress
+    uint32_t names_epoch;    // bumped when the name pool is compacted
+    uint32_t name_count;     // names only grow between compactions
+    uint32_t record_count;
+    SharedName names[ScoreTable::MAX_PLAYERS];
+    ScoreRecord records[ScoreTable::MAX_RECORDS];
+};
+
+SharedScores::~SharedScores() {
+    if (seg_) munmap(seg_, sizeof(SharedSegment));
+}
+
+// One segment per leaderboard file, keyed by a hash of its absolute path.
+string SharedScores::segment_name(const string& path) {
+    string abs = path;
+    if (abs.empty() || abs[0] != '/') {
+        char cwd[4096];
+        if (getcwd(cwd, sizeof(cwd))) abs = string(cwd) + "/" + path;
+    }
+    uint32_t h = 2166136261u; // FNV-1a
+    for (unsigned char ch : abs) { h ^= ch; h *= 16777619u; }
+    char buf[40];
+    snprintf(buf, sizeof(buf), "/snaketerra-%08x", h);
+    return buf;
+}
+
+bool SharedScores::attach(const string& path, const function<void(ScoreTable&)>& init) {
+    const string name = segment_name(path);
+    auto unavailable = [&](const char* why) {
+        fprintf(stderr, "snaketerra: shared leaderboard %s unavailable (%s); using %s directly\n",
+                name.c_str(), why, path.c_str());
+        return false;
+    };
+    bool creator = true;
+    const mode_t mode = file_mode(path);
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, mode);
+    if (fd < 0 && errno == EEXIST) {
+        creator = false;
+        fd = shm_open(name.c_str(), O_RDWR, mode);
+    }
+    if (fd < 0) return unavailable(strerror(errno));
+
+    if (creator) {
+        // shm_open applies the umask; everyone who may write the file must be
+        // able to open the segment too
+        if (fchmod(fd, mode) != 0 || ftruncate(fd, sizeof(SharedSegment)) != 0) {
+            const int err = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            return unavailable(strerror(err));
+        }
+    } else {
+        // the creator may not have sized it yet; mapping early would SIGBUS
+        struct stat st;
+        int waited = 0;
+        while (fstat(fd, &st) == 0 && st.st_size < (off_t)sizeof(SharedSegment) && waited < 200) {
+            this_thread::sleep_for(5ms);
+            ++waited;
+        }
+        if (st.st_size < (off_t)sizeof(SharedSegment)) {
+            close(fd);
+            shm_unlink(name.c_str()); // stale or older layout; recreate next time
+            return unavailable("stale segment removed");
+        }
+    }
+
+    void* p = mmap(nullptr, sizeof(SharedSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int map_err = errno;
+    close(fd);
+    if (p == MAP_FAILED) return unavailable(strerror(map_err));
+    SharedSegment* seg = static_cast<SharedSegment*>(p);
+
+    if (creator) {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&seg->writer, &attr);
+        pthread_mutexattr_destroy(&attr);
+        // hold the writer lock while filling so others can wait on it
+        pthread_mutex_lock(&seg->writer);
+        seg->magic = SEGMENT_MAGIC;
+        seg->locked.store(1, memory_order_release);
+        seg->seq.store(0, memory_order_relaxed);
+        seg->names_epoch = 0;
+        seg->name_count = 0;
+        seg->record_count = 0;
+        seg_ = seg;
+        ScoreTable initial;
+        init(initial);
+        copy_in(initial);
+        seg->ready.store(1, memory_order_release);
+        unlock();
+        return true;
+    }
+
+    // Once the creator holds the writer lock, block on it for as long as the
+    // creator takes to fill the table; EOWNERDEAD means it died part-way.
+    int waited = 0;
+    while (seg->locked.load(memory_order_acquire) == 0 && waited < 200) {
+        this_thread::sleep_for(5ms);
+        ++waited;
+    }
+    const char* why = nullptr;
+    bool drop = true; // let the next session start a fresh segment
+    if (seg->locked.load(memory_order_acquire) == 0) {
+        why = "creator exited before setting it up";
+    } else if (seg->magic != SEGMENT_MAGIC) {
+        why = "incompatible layout";
+    } else {
+        int rc = pthread_mutex_lock(&seg->writer);
+        if (rc == EOWNERDEAD) pthread_mutex_consistent(&seg->writer);
+        if (seg->ready.load(memory_order_acquire) == 0) {
+            why = "creator exited before filling it";
+            // only the first waiter to inherit the lock unlinks, so a
+            // replacement segment made meanwhile is left alone
+            drop = rc == EOWNERDEAD;
+        }
+        if (rc == 0 || rc == EOWNERDEAD) pthread_mutex_unlock(&seg->writer);
+    }
+    if (why) {
+        munmap(seg, sizeof(SharedSegment));
+        if (drop) shm_unlink(name.c_str());
+        return unavailable(why);
+    }
+    seg_ = seg;
+    return true;
+}
+
+uint32_t SharedScores::version() const {
+    return seg_ ? seg_->seq.load(memory_order_acquire) : 0;
+}
+
+void SharedScores::read(ScoreTable& out) const {
+    for (int tries = 0; tries < 1000; ++tries) {
+        if (try_copy_out(out, seen_epoch_, false)) return;
+        this_thread::yield();
+    }
+    // a writer died mid-update or keeps winning: read under the lock instead
+    lock();
+    try_copy_out(out, seen_epoch_, true);
+    unlock();
+}
+
+void SharedScores::update(const function<void(ScoreTable&)>& fn) {
+    lock();
+    ScoreTable cur;
+    uint32_t epoch = seg_->names_epoch;
+    try_copy_out(cur, epoch, true);
+    fn(cur);
+    uint32_t s = seg_->seq.load(memory_order_relaxed);
+    if (!(s & 1)) seg_->seq.store(++s, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    copy_in(cur);
+    seg_->seq.store(s + 1, memory_order_release);
+    unlock();
+}
+
+void SharedScores::remove(const string& path) {
+    shm_unlink(segment_name(path).c_str());
+}
+
+mode_t SharedScores::file_mode(const string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) return st.st_mode & 0666;
+    mode_t mask = umask(0);
+    umask(mask);
+    return 0666 & ~mask;
+}
+
+void SharedScores::lock() const {
+    // a writer that died holding the lock left seq odd; update() repairs it
+    if (pthread_mutex_lock(&seg_->writer) == EOWNERDEAD) pthread_mutex_consistent(&seg_->writer);
+}
+
+void SharedScores::unlock() const {
+    pthread_mutex_unlock(&seg_->writer);
+}
+
+// Copies into temporaries first so a torn read never touches `out`.
+// `epoch` is the pool generation `out` was last filled from.
+bool SharedScores::try_copy_out(ScoreTable& out, uint32_t& epoch, bool locked) const {
+    uint32_t s1 = seg_->seq.load(memory_order_acquire);
+    if (!locked && (s1 & 1)) return false;
+    const uint32_t names_epoch = seg_->names_epoch;
+    const uint32_t nn = min(seg_->name_count, (uint32_t)ScoreTable::MAX_PLAYERS);
+    const uint32_t nr = min(seg_->record_count, (uint32_t)ScoreTable::MAX_RECORDS);
+    const bool full = names_epoch != epoch || (uint32_t)out.player_count() > nn;
+    const uint32_t from = full ? 0 : (uint32_t)out.player_count();
+
+    vector<ScoreRecord> records(seg_->records, seg_->records + nr);
+    vector<SharedName> names(nn - from);
+    if (!names.empty()) memcpy(names.data(), seg_->names + from, names.size() * sizeof(SharedName));
+    if (!locked) {
+        atomic_thread_fence(memory_order_acquire);
+        if (seg_->seq.load(memory_order_relaxed) != s1) return false;
+    }
+
+    if (full) out.clear();
+    for (auto& n : names) {
+        n.s[ScoreTable::NAME_LEN] = '\0';
+        out.append_name(n.s);
+    }
+    out.records().swap(records);
+    epoch = names_epoch;
+    return true;
+}
+
+// Caller holds the writer lock with seq odd.
+void SharedScores::copy_in(const ScoreTable& in) {
+    const uint32_t old_nn = seg_->name_count;
+    const uint32_t nn = (uint32_t)in.player_count();
+    uint32_t from = old_nn;
+    if (nn < old_nn) from = 0;
+    for (uint32_t i = 0; i < from; ++i) {
+        if (strncmp(seg_->names[i].s, in.name((uint16_t)i), ScoreTable::NAME_LEN) != 0) { from = 0; break; }
+    }
+    if (from == 0 && old_nn > 0) seg_->names_epoch += 1; // ids were renumbered
+    for (uint32_t i = from; i < nn; ++i) {
+        memset(seg_->names[i].s, 0, sizeof(SharedName));
+        strncpy(seg_->names[i].s, in.name((uint16_t)i), ScoreTable::NAME_LEN);
+    }
+    seg_->name_count = nn;
+    const auto& recs = in.records();
+    const size_t nr = min(recs.size(), (size_t)ScoreTable::MAX_RECORDS);
+    if (nr) memcpy(seg_->records, recs.data(), nr * sizeof(ScoreRecord));
+    seg_->record_count = (uint32_t)nr;
+}
+
+} // namespace snaketerra
@@ -0,0 +1,106 @@
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace snaketerra {
+namespace trace {
+
+bool g_enabled = false;
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+};
+
+// Single-producer ring owned by one thread. When full the oldest events are
+// overwritten; the exporter reads the newest min(head, CAPACITY) slots.
+struct Ring {
+    static const size_t CAPACITY = 1 << 16;
+    Event events[CAPACITY];
+    atomic<uint64_t> head{0};
+    int tid = 0;
+};
+
+mutex g_rings_mu; // only taken when a thread records its first event
+vector<unique_ptr<Ring>> g_rings;
+string g_path;
+uint64_t g_origin_ns = 0;
+
+Ring* this_thread_ring() {
+    thread_local Ring* ring = nullptr;
+    if (!ring) {
+        lock_guard<mutex> lk(g_rings_mu);
+        g_rings.emplace_back(new Ring());
+        ring = g_rings.back().get();
+        ring->tid = (int)g_rings.size();
+    }
+    return ring;
+}
+
+void write_escaped(FILE* f, const char* s) {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        fputc(*s, f);
+    }
+}
+
+} // namespace
+
+uint64_t now_ns() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record(const char* name, uint64_t begin_ns, uint64_t end_ns) {
+    Ring* r = this_thread_ring();
+    uint64_t h = r->head.load(memory_order_relaxed);
+    r->events[h % Ring::CAPACITY] = {name, begin_ns, end_ns};
+    r->head.store(h + 1, memory_order_release);
+}
+
+void start(const string& path) {
+    g_path = path;
+    g_origin_ns = now_ns();
+    g_enabled = true;
+    static bool registered = false;
+    if (!registered) { atexit(flush); registered = true; }
+}
+
+void flush() {
+    if (!g_enabled) return;
+    g_enabled = false;
+    FILE* f = fopen(g_path.c_str(), "w");
+    if (!f) return;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"SnakeTerra\"}}");
+    lock_guard<mutex> lk(g_rings_mu);
+    for (const auto& r : g_rings) {
+        uint64_t head = r->head.load(memory_order_acquire);
+        uint64_t first = head > Ring::CAPACITY ? head - Ring::CAPACITY : 0;
+        for (uint64_t i = first; i < head; ++i) {
+            const Event& e = r->events[i % Ring::CAPACITY];
+            fprintf(f, ",\n{\"name\":\"");
+            write_escaped(f, e.name);
+            // microseconds printed from integers: %f would follow the
+            // locale ncurses set up and could emit a decimal comma
+            unsigned long long ts = e.begin_ns - g_origin_ns, dur = e.end_ns - e.begin_ns;
+            fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu.%03llu,\"dur\":%llu.%03llu}",
+                    r->tid, ts / 1000, ts % 1000, dur / 1000, dur % 1000);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+}
+
+} // namespace trace
+} // namespace snaketerra
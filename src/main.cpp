@@ -1,11 +1,42 @@
 #include "GameBoard.h"
+#include "Bench.h"
+#include "Trace.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 using namespace std;
 
-int main() {
+int main(int argc, char** argv) {
+    bool half_block = false;
+    bool bench = false;
+    int bench_rounds = 1;
+    const char* trace_path = nullptr;
+
+    // parse every flag first so their order does not matter
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) bench_rounds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--half-block") == 0) {
+            half_block = true;
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 >= argc || argv[i + 1][0] == '-') {
+                fprintf(stderr, "snaketerra: --trace needs an output path (e.g. --trace out.json)\n");
+                return 2;
+            }
+            trace_path = argv[++i];
+        }
+    }
+
+    if (trace_path) snaketerra::trace::start(trace_path);
+    if (bench) return snaketerra::run_bench(bench_rounds);
+
     snaketerra::GameBoard gb(20, 30);
+    gb.set_half_block(half_block);
     gb.init_ncurses();
     gb.run();
     // shutdown handled inside run on quit
     return 0;
-}
\ No newline at end of file
+}